@@ -14,6 +14,7 @@ CONF_UART_TIMEOUT_LAMBDA = "uart_timeout_lambda"
 CONF_UART_TIMEOUT_DROP_CLIENTS = "uart_timeout_drop_clients"
 CONF_UART_KEEPALIVE_INTERVAL = "uart_keepalive_interval"
 CONF_UART_KEEPALIVE_MESSAGE = "uart_keepalive_message"
+CONF_UART_FRAMING = "uart_framing"
 
 CONF_TCP_BUFFER_SIZE = "tcp_buffer_size"
 CONF_TCP_TERMINATOR = "tcp_terminator"
@@ -68,6 +69,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_UART_TIMEOUT_DROP_CLIENTS, default=False): cv.boolean,
             cv.Optional(CONF_UART_KEEPALIVE_INTERVAL, default="0s"): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_UART_KEEPALIVE_MESSAGE, default=""): cv.string,
+            cv.Optional(CONF_UART_FRAMING, default=False): cv.boolean,
             }
         )
     .extend(cv.COMPONENT_SCHEMA)
@@ -87,6 +89,7 @@ async def to_code(config):
     cg.add(var.set_keepalive_message(config[CONF_UART_KEEPALIVE_MESSAGE]))
     cg.add(var.set_keepalive_interval(config[CONF_UART_KEEPALIVE_INTERVAL]))
     cg.add(var.set_drop_on_uart_timeout(config[CONF_UART_TIMEOUT_DROP_CLIENTS]))
+    cg.add(var.set_uart_framing(config[CONF_UART_FRAMING]))
 
     if CONF_UART_TIMEOUT_LAMBDA in config:
         uart_lambda_ = await cg.process_lambda(
@@ -13,6 +13,35 @@ using namespace esphome;
 
 static const char *const TAG = "line_server";
 
+static const char *gap_reason_to_str(GapReason reason) {
+  switch (reason) {
+    case GapReason::TcpTruncated:
+      return "tcp_truncated";
+    case GapReason::NoClient:
+      return "no_client";
+    case GapReason::UartTimeout:
+      return "uart_timeout";
+    case GapReason::TcpSend:
+      return "tcp_send";
+    case GapReason::TcpOverflow:
+      return "tcp_overflow";
+    case GapReason::TcpTimeout:
+      return "tcp_timeout";
+    default:
+      return "unknown";
+  }
+}
+
+// Removes every occurrence of the terminator, so a framed body stays on one line
+static void strip_terminator(std::string &text, const std::string &terminator) {
+  if (terminator.empty())
+    return;
+
+  size_t pos;
+  while ((pos = text.find(terminator)) != std::string::npos)
+    text.erase(pos, terminator.size());
+}
+
 void LineServerComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up line server...");
 
@@ -68,6 +97,7 @@ ESP_LOGCONFIG(TAG, "- TCP buffer: size=%zu, terminator=%s",
       tcp_buf_size_,
       esphome::format_hex_pretty((const uint8_t*)tcp_terminator_.data(), tcp_terminator_.size()).c_str());
   ESP_LOGCONFIG(TAG, "- TCP flush timeout: %ums", tcp_flush_timeout_ms_);
+  ESP_LOGCONFIG(TAG, "- UART framing: %s", YESNO(uart_framing_));
 
 #ifdef USE_BINARY_SENSOR
   LOG_BINARY_SENSOR("  ", "Connected:", this->connected_sensor_);
@@ -103,15 +133,23 @@ void LineServerComponent::accept() {
 
     if (!this->has_active_clients()) {
         ESP_LOGW(TAG, "No active clients connected, flushing UART RX buffer");
-        if (this->uart_buf_)
+        if (this->uart_buf_) {
+            this->uart_dropped_bytes_ += this->uart_buf_->available();
             this->uart_buf_->clear();
-        this->flush_uart_rx_buffer();
+        }
+        this->uart_dropped_bytes_ += this->flush_uart_rx_buffer();
     }
 
     client_sock->setblocking(false);
     std::string identifier = client_sock->getpeername();
     this->clients_.emplace_back(std::move(client_sock), identifier);
 
+    // Let the new client know whether it missed anything while nobody was listening
+    if (this->uart_dropped_bytes_ > 0) {
+        this->mark_gap(this->clients_.back(), GapReason::NoClient, this->uart_dropped_bytes_, esphome::millis());
+        this->uart_dropped_bytes_ = 0;
+    }
+
     ESP_LOGD(TAG, "New client connected from %s", identifier.c_str());
     this->publish_sensor();
 }
@@ -137,6 +175,7 @@ void LineServerComponent::cleanup() {
         this->uart_buf_ && this->uart_buf_->available() > 0) {
 
       ESP_LOGW(TAG, "Deadlock prevention: UART stuck in WaitingResponse without timeout — clearing buffer");
+      this->uart_dropped_bytes_ += this->uart_buf_->available();
       this->uart_buf_->clear();
       this->uart_state_ = UartState::Free;
     }
@@ -181,6 +220,7 @@ void LineServerComponent::read() {
             this->uart_buf_->advance_head(read_len);
         } else {
             ESP_LOGV(TAG, "Discarded %zu bytes from UART (no clients connected)", read_len);
+            this->uart_dropped_bytes_ += read_len;
         }
     }
 }
@@ -191,6 +231,12 @@ void LineServerComponent::flush_uart_buffer() {
 
     const uint32_t now = esphome::millis();
 
+    // Report drops recorded since the last loop before any new line goes out
+    this->flush_gaps(now);
+
+    // Lines are read from UART earlier in the same loop, so the last write is their capture time
+    const uint32_t captured = this->uart_buf_->last_write_time();
+
     // Flush full lines
     while (true) {
         std::string line = this->uart_buf_->read_line();
@@ -200,10 +246,7 @@ void LineServerComponent::flush_uart_buffer() {
         this->uart_state_ = UartState::WaitingResponse;
 
         ESP_LOGD(TAG, "UART → TCP [line]: '%s'", line.c_str());
-        for (Client &client : this->clients_) {
-            if (!client.disconnected)
-                client.socket->write(reinterpret_cast<const uint8_t *>(line.data()), line.size());
-        }
+        this->send_to_clients(line, captured, now);
     }
 
     // Handle stale partials
@@ -211,25 +254,37 @@ void LineServerComponent::flush_uart_buffer() {
         (now - uart_buf_->last_write_time()) >= this->uart_flush_timeout_ms_ &&
         uart_buf_->available() > 0) {
 
+        const size_t stale = uart_buf_->available();
+
         if (this->uart_timeout_callback_) {
-            std::string partial = uart_buf_->read_line();  // Optional: switch to read_partial()
+            std::string partial = uart_buf_->read_partial();
             std::string processed = this->uart_timeout_callback_(partial);
 
+            // Anything the lambda never got to see is lost
+            if (partial.size() < stale)
+                this->mark_gap_all(GapReason::UartTimeout, stale - partial.size(), now);
+
+            // Embedded terminators would split the frame into unnumbered lines
+            if (this->uart_framing_)
+                strip_terminator(processed, this->uart_terminator_);
+
             if (!processed.empty()) {
                 ESP_LOGW(TAG, "UART → TCP [timeout flush]: \'%s\'", processed.c_str());
-                for (Client &client : this->clients_) {
-                    if (!client.disconnected)
-                        client.socket->write(reinterpret_cast<const uint8_t *>(processed.data()), processed.size());
-                }
+                this->send_to_clients(processed, captured, now);
             } else {
                 ESP_LOGW(TAG, "UART line timed out and was discarded by lambda");
+                this->mark_gap_all(GapReason::UartTimeout, partial.size(), now);
             }
         } else {
-            ESP_LOGW(TAG, "UART line timed out without terminator — discarding partial: size=%zu", uart_buf_->available());
+            ESP_LOGW(TAG, "UART line timed out without terminator — discarding partial: size=%zu", stale);
+            this->mark_gap_all(GapReason::UartTimeout, stale, now);
         }
         this->uart_state_ = UartState::Free;
         uart_buf_->clear();  // Always clear after handling
 
+        // Report the discard right away (and before clients are dropped below)
+        this->flush_gaps(now);
+
         if (this->drop_on_uart_timeout_) {
             ESP_LOGW(TAG, "UART timeout — dropping TCP clients");
             for (auto &client : this->clients_) {
@@ -257,6 +312,7 @@ void LineServerComponent::write() {
                 size_t written = this->tcp_buf_->write_array(temp, len);
                 if (written < static_cast<size_t>(len)) {
                     ESP_LOGW(TAG, "TCP buffer overflow — dropped %zu bytes", len - written);
+                    this->mark_gap(client, GapReason::TcpOverflow, len - written, esphome::millis());
                 }
             } else if (len == 0 || errno == ECONNRESET) {
                 ESP_LOGD(TAG, "Client %s disconnected during read", client.identifier.c_str());
@@ -304,10 +360,12 @@ void LineServerComponent::flush_tcp_buffer() {
                 this->uart_bus_->write_array(reinterpret_cast<const uint8_t *>(processed.data()), processed.size());
             } else {
                 ESP_LOGW(TAG, "TCP input timed out and was discarded by lambda");
+                this->mark_gap_all(GapReason::TcpTimeout, partial.size(), now);
             }
         } else {
             std::string partial = tcp_buf_->read_partial();
             ESP_LOGW(TAG, "TCP input timed out without terminator — discarding partial: size=%zu", partial.size());
+            this->mark_gap_all(GapReason::TcpTimeout, partial.size(), now);
         }
 
         tcp_buf_->clear();  // Always clear after timeout handling
@@ -330,9 +388,9 @@ void LineServerComponent::send_uart_keepalive() {
     this->last_keepalive_ = now;
 }
 
-void LineServerComponent::flush_uart_rx_buffer() {
+size_t LineServerComponent::flush_uart_rx_buffer() {
     uint8_t discard;
-    int count = 0;
+    size_t count = 0;
     while (this->uart_bus_->available() > 0) {
         if (this->uart_bus_->read_byte(&discard)) {
             count++;
@@ -342,7 +400,110 @@ void LineServerComponent::flush_uart_rx_buffer() {
     }
 
     if (count > 0)
-        ESP_LOGD(TAG, "Flushed %d bytes from UART RX buffer", count);
+        ESP_LOGD(TAG, "Flushed %zu bytes from UART RX buffer", count);
+    return count;
+}
+
+void LineServerComponent::send_to_clients(const std::string &payload, uint32_t captured, uint32_t now) {
+    for (Client &client : this->clients_) {
+        if (client.disconnected)
+            continue;
+
+        if (!this->uart_framing_) {
+            client.socket->write(reinterpret_cast<const uint8_t *>(payload.data()), payload.size());
+            continue;
+        }
+
+        // A pending gap must reach the client before any later line does
+        // The socket just refused the marker, so don't retry it via mark_gap()
+        if (!this->send_gap(client, now)) {
+            client.gap_bytes[static_cast<size_t>(GapReason::TcpSend)] += payload.size();
+            continue;
+        }
+
+        // A truncated frame is reported by write_frame() itself as tcp_truncated
+        if (this->write_frame(client, "D " + payload, captured) == FrameWrite::NotSent)
+            this->mark_gap(client, GapReason::TcpSend, payload.size(), now);
+    }
+}
+
+// Frame layout: "<seq> <millis> <body>" followed by the UART terminator.
+// The sequence number is per client and is only consumed once part of the
+// frame reached the socket. After a partial write the next frame is preceded
+// by a bare terminator so it starts on its own line, and a tcp_truncated gap
+// tells the client to discard the line that was cut short.
+FrameWrite LineServerComponent::write_frame(Client &client, const std::string &body, uint32_t timestamp) {
+    char header[24];
+    snprintf(header, sizeof(header), "%u %u ", static_cast<unsigned>(client.seq), static_cast<unsigned>(timestamp));
+
+    std::string frame = client.mid_frame ? this->uart_terminator_ : std::string();
+    const ssize_t prefix = frame.size();
+    frame += header;
+    frame += body;
+    if (!esphome::str_endswith(frame, this->uart_terminator_))
+        frame += this->uart_terminator_;
+
+    ssize_t written = client.socket->write(reinterpret_cast<const uint8_t *>(frame.data()), frame.size());
+    if (written >= prefix)
+        client.mid_frame = false;
+    if (written <= prefix)
+        return FrameWrite::NotSent;
+
+    client.seq++;
+    if (written == static_cast<ssize_t>(frame.size()))
+        return FrameWrite::Sent;
+
+    client.mid_frame = true;
+    client.gap_bytes[static_cast<size_t>(GapReason::TcpTruncated)] += frame.size() - prefix;
+    return FrameWrite::Truncated;
+}
+
+// Sends one marker per pending reason. Stops at the first frame that does not
+// go out whole; its count stays pending and is retried on the next call.
+bool LineServerComponent::send_gap(Client &client, uint32_t now) {
+    for (size_t i = 0; i < static_cast<size_t>(GapReason::Count); i++) {
+        if (client.gap_bytes[i] == 0)
+            continue;
+
+        const char *reason = gap_reason_to_str(static_cast<GapReason>(i));
+        char body[48];
+        snprintf(body, sizeof(body), "G %s %zu", reason, client.gap_bytes[i]);
+        if (this->write_frame(client, body, now) != FrameWrite::Sent)
+            return false;
+
+        ESP_LOGW(TAG, "Gap reported to client %s: reason=%s, dropped=%zu bytes",
+                 client.identifier.c_str(), reason, client.gap_bytes[i]);
+        client.gap_bytes[i] = 0;
+    }
+    return true;
+}
+
+void LineServerComponent::mark_gap(Client &client, GapReason reason, size_t bytes, uint32_t now) {
+    if (!this->uart_framing_ || bytes == 0)
+        return;
+
+    // Report drops of another kind first so each marker counts a single reason
+    size_t &pending = client.gap_bytes[static_cast<size_t>(reason)];
+    if (pending == 0)
+        this->send_gap(client, now);
+    pending += bytes;
+}
+
+void LineServerComponent::mark_gap_all(GapReason reason, size_t bytes, uint32_t now) {
+    for (Client &client : this->clients_) {
+        if (!client.disconnected)
+            this->mark_gap(client, reason, bytes, now);
+    }
+}
+
+void LineServerComponent::flush_gaps(uint32_t now) {
+    if (!this->uart_framing_)
+        return;
+
+    for (Client &client : this->clients_) {
+        if (!client.disconnected)
+            this->send_gap(client, now);
+    }
 }
 
 
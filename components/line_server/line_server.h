@@ -28,6 +28,23 @@ enum class UartState {
     WaitingKeepAlive
   };
 
+// Reasons reported in gap markers, in the order pending markers are sent
+enum class GapReason : uint8_t {
+    TcpTruncated,   // the previous frame was cut short by a partial socket write
+    NoClient,
+    UartTimeout,
+    TcpSend,
+    TcpOverflow,
+    TcpTimeout,
+    Count
+  };
+
+enum class FrameWrite {
+    Sent,
+    NotSent,
+    Truncated
+  };
+
 class LineServerComponent : public esphome::Component {
 public:
     void set_uart_parent(esphome::uart::UARTComponent *parent) { this->uart_bus_ = parent; }
@@ -62,6 +79,7 @@ public:
     void set_keepalive_message(const std::string &message) { keepalive_message_ = message; }
 
     void set_drop_on_uart_timeout(bool drop) { drop_on_uart_timeout_ = drop; }
+    void set_uart_framing(bool framing) { uart_framing_ = framing; }
 
     void send_uart_keepalive();
 
@@ -69,6 +87,7 @@ public:
     uint32_t keepalive_interval_ms_ = 0;
     std::string keepalive_message_;
     bool drop_on_uart_timeout_ = false;
+    bool uart_framing_ = false;
 
 #ifdef USE_BINARY_SENSOR
     void set_connected_sensor(esphome::binary_sensor::BinarySensor *connected) { connected_sensor_ = connected; }
@@ -99,8 +118,20 @@ protected:
         std::unique_ptr<esphome::socket::Socket> socket;
         std::string identifier;
         bool disconnected = false;
+
+        // Framing state (only used when uart_framing_ is enabled)
+        uint32_t seq = 0;                   // next sequence number for this client
+        bool mid_frame = false;             // last frame was cut short by a partial write
+        size_t gap_bytes[static_cast<size_t>(GapReason::Count)] = {};  // pending drops per reason
     };
 
+    void send_to_clients(const std::string &payload, uint32_t captured, uint32_t now);
+    FrameWrite write_frame(Client &client, const std::string &body, uint32_t timestamp);
+    bool send_gap(Client &client, uint32_t now);
+    void mark_gap(Client &client, GapReason reason, size_t bytes, uint32_t now);
+    void mark_gap_all(GapReason reason, size_t bytes, uint32_t now);
+    void flush_gaps(uint32_t now);
+
     esphome::uart::UARTComponent *uart_bus_{nullptr};                 // reference to UART bus
     std::unique_ptr<esphome::uart::UARTDevice> stream_{nullptr};
 
@@ -114,7 +145,9 @@ protected:
     std::string tcp_terminator_ = "\r";
     uint32_t tcp_flush_timeout_ms_ = 300;
 
-    void flush_uart_rx_buffer();
+    size_t flush_uart_rx_buffer();
+
+    size_t uart_dropped_bytes_ = 0;     // UART bytes discarded while no client was connected
 
     UartState uart_state_ = UartState::Free;
 